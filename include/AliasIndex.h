@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ChimeraTK::command_line_tools {
+
+  /** Device entry of the alias index */
+  struct AliasIndexEntry {
+    std::string alias;
+    std::string uri;         // as given in the dmap file
+    std::string mapFileName; // separate map file column of the dmap file, empty for CDDs
+    std::string cdd;         // CDD which can be opened without the dmap file, empty if there is none
+  };
+
+  /********************************************************************************************************************/
+
+  /**
+   * Precompiled index of the devices in a dmap file.
+   *
+   * With the index, a device alias can be opened through its CDD, and the devices can be listed, without parsing the
+   * dmap file. The index is a pure cache: It is stored in $XDG_CACHE_HOME/mtca4u (or ~/.cache/mtca4u), is validated
+   * against size and modification time of the dmap file and is read with a single mmap. If it is missing or outdated,
+   * the dmap file is parsed once and the result is used directly. Storing the new index is attempted once, failures
+   * (e.g. a read-only cache directory) are ignored. Set the environment variable MTCA4U_NO_ALIAS_INDEX to disable the
+   * index file.
+   *
+   * Only devices of backends which need nothing but their CDD get a standalone CDD. These are the numeric addressed
+   * backends in dmap files without plugin libraries. All other devices have to be opened by their alias with the dmap
+   * file set in DeviceAccess.
+   */
+  class AliasIndex {
+   public:
+    /** Load the index of the given dmap file. Throws ChimeraTK::logic_error if the dmap file cannot be parsed. */
+    explicit AliasIndex(const std::string& dmapFileName);
+
+    /** All devices of the dmap file, in the order of the file. */
+    const std::vector<AliasIndexEntry>& getEntries() const { return _entries; }
+
+    /** The entry for the alias. Returns nullptr if the dmap file does not contain the alias. */
+    const AliasIndexEntry* find(const std::string& alias) const;
+
+    /** Whether the index was read from the index file, i.e. the dmap file has not been parsed. */
+    bool isFromIndexFile() const { return _isFromIndexFile; }
+
+   private:
+    bool readIndexFile(const std::string& indexFileName, const std::string& expectedHeader);
+    void parseDMapFile(const std::string& dmapFileName);
+    void writeIndexFile(const std::string& indexFileName, const std::string& header) const;
+
+    std::vector<AliasIndexEntry> _entries;
+    bool _isFromIndexFile{false};
+  };
+
+} // namespace ChimeraTK::command_line_tools
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+/*
+ * Implementation of the mtca4u commands, which print their results to std::cout. The mtca4u executable only parses
+ * the options and dispatches to them, the benchmarks call them in-process. This header is not installed.
+ */
+
+#include "Session.h"
+
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+// typedefs and Functions declarations
+using Session = ChimeraTK::command_line_tools::Session;
+
+void printSeqList(std::vector<double> const& values, size_t numSequencesInList, uint elements);
+std::vector<std::string> createArgList(uint argc, const char* argv[], uint maxArgs);
+std::vector<uint> extractSequenceList(std::string const& list, uint numSequences);
+uint extractOffset(std::string const& userEnteredOffset, uint maxOffset = std::numeric_limits<uint>::max());
+uint extractNumElements(
+    std::string const& userEnteredValue, uint offset, uint maxElements = std::numeric_limits<uint>::max());
+std::string extractDisplayMode(const std::string& displayMode);
+std::vector<uint> createListWithAllSequences(uint numSequences);
+// converts a std::string to uint, catches and replaces the conversion exception, and
+// returns 0 if the std::string is empty
+uint stringToUIntWithZeroDefault(const std::string& userEnteredValue);
+void readRegisterInternal(Session& session, const std::vector<std::string>& argList);
+
+using CmdFnc = std::function<void(Session&, unsigned int, const char**)>;
+
+struct Command {
+  std::string name;
+  CmdFnc callback;
+  std::string description;
+  std::string example;
+};
+
+/**********************************************************************************************************************/
+
+// Forward declarations of subcommands
+void printHelp(Session&, unsigned int, const char**);
+void getVersion(Session&, unsigned int, const char**);
+void getInfo(Session&, unsigned int, const char**);
+void getDeviceInfo(Session&, unsigned int, const char**);
+void getRegisterInfo(Session&, unsigned int, const char**);
+void getRegisterSize(Session&, unsigned int, const char**);
+void readRegister(Session&, unsigned int, const char**);
+void writeRegister(Session&, unsigned int, const char**);
+void readDmaRawData(Session&, unsigned int, const char**);
+void readMultiplexedData(Session&, unsigned int, const char**);
+
+/**********************************************************************************************************************/
+
+// All commands with their help text
+extern std::vector<Command> vectorOfCommands;
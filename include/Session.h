@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <ChimeraTK/Device.h>
+#include <ChimeraTK/OneDRegisterAccessor.h>
+#include <ChimeraTK/RegisterPath.h>
+#include <ChimeraTK/TwoDRegisterAccessor.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ChimeraTK::command_line_tools {
+
+  class AliasIndex;
+
+  /********************************************************************************************************************/
+
+  /**
+   * Determine the dmap file to use. In order of precedence this is explicitDMapFileName, the file given in the
+   * environment variable MTCA4U_DMAP_FILE, or a dmap file in the current directory.
+   * Returns an empty std::string if not found.
+   */
+  std::string findDMapFile(const std::string& explicitDMapFileName = "");
+
+  /********************************************************************************************************************/
+
+  /** Dimensions of a multiplexed data region */
+  struct SequenceInfo {
+    size_t nSequences;
+    size_t nElementsPerSequence;
+  };
+
+  /** Entry of the dmap file */
+  struct DeviceEntry {
+    std::string alias;
+    std::string cdd;
+    std::string mapFileName; // empty if the map file is part of the CDD
+  };
+
+  /** Description of a register from the register catalogue */
+  struct RegisterEntry {
+    ChimeraTK::RegisterPath name;
+    size_t nDimensions;
+    size_t nChannels;
+    size_t nElements;
+    // Only valid if isNumericAddressed is set. For multiple channels this is the information of the first channel.
+    bool isNumericAddressed;
+    bool signedFlag;
+    uint32_t width;
+    int32_t nFractionalBits;
+  };
+
+  /********************************************************************************************************************/
+
+  /**
+   * In-process implementation of the mtca4u commands.
+   *
+   * A session keeps the devices and register accessors it has opened, so repeated calls only transfer data. At most
+   * maxCachedAccessors accessors of each kind are kept, when the limit is reached the cached accessors are dropped.
+   * A device which is no longer functional after a runtime_error is reopened on the next access. Results are written
+   * into caller-provided buffers. Errors are reported as ChimeraTK::logic_error (bad arguments, unknown
+   * devices or registers) and ChimeraTK::runtime_error (I/O errors).
+   *
+   * Devices are identified by an alias, a ChimeraTK Device Descriptor (CDD) or an SDM URI. Aliases are resolved with
+   * the dmap file passed to the constructor, or with findDMapFile() if none is given. The aliases are looked up in a
+   * precompiled index of the dmap file (see AliasIndex), so a device of a numeric addressed backend is opened through
+   * its CDD without parsing the dmap file. Other devices are opened by their alias. Since the dmap file path is a
+   * process wide setting in DeviceAccess, it is set each time a device is opened that way.
+   *
+   * A session is not thread safe.
+   */
+  class Session {
+   public:
+    explicit Session(std::string dmapFileName = "");
+    ~Session();
+    Session(Session&&) noexcept;
+    Session& operator=(Session&&) noexcept;
+
+    /**
+     * The dmap file used to resolve aliases, determined with findDMapFile() on first use. Returns an empty string if
+     * there is none.
+     */
+    const std::string& getDMapFileName();
+
+    /** All devices listed in the dmap file. Throws if there is no dmap file. */
+    std::vector<DeviceEntry> getDeviceList();
+
+    /** Close all devices and drop the cached accessors and the alias index. The next access opens the devices again. */
+    void clear();
+
+    /**
+     * Get the opened device. The device is opened on first use, and reopened if it is not functional (e.g. after a
+     * runtime_error).
+     */
+    ChimeraTK::Device& getDevice(const std::string& deviceName);
+
+    /** All registers of a device, in the order of the register catalogue. */
+    std::vector<RegisterEntry> getRegisterList(const std::string& deviceName);
+
+    /** Description of a single register. */
+    RegisterEntry getRegisterInfo(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath);
+
+    /** Number of elements of a register. For 2D registers it is the size of one channel. */
+    size_t getRegisterSize(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath);
+
+    /**
+     * Number of elements a read of numElements elements at the given offset delivers. If numElements is 0, this is
+     * the size of the register. Throws if the requested range does not fit into the register.
+     * Use UserType = int32_t for raw access as in readRaw(), double for converted access as in read() and write().
+     */
+    template<typename UserType = double>
+    size_t getNumberOfElements(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+        size_t numElements = 0, size_t offset = 0);
+
+    /** Read values.size() elements starting at offset, converted to double. */
+    void read(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath, std::span<double> values,
+        size_t offset = 0);
+
+    /** Read values.size() raw elements starting at offset, without fixed point conversion. */
+    void readRaw(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+        std::span<int32_t> values, size_t offset = 0);
+
+    /** Write values.size() elements starting at offset. */
+    void write(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+        std::span<const double> values, size_t offset = 0);
+
+    /** Number of sequences and their length of a multiplexed data region. */
+    SequenceInfo getSequenceInfo(const std::string& deviceName, const ChimeraTK::RegisterPath& regionPath);
+
+    /**
+     * Read the demultiplexed sequences given in sequenceList, starting at offset in each sequence. The number of
+     * elements per sequence is values.size() / sequenceList.size(), values.size() must be a multiple of
+     * sequenceList.size(). The values are stored element by element, i.e. values[i * sequenceList.size() + j] is
+     * element offset + i of sequence sequenceList[j].
+     */
+    void readSequences(const std::string& deviceName, const ChimeraTK::RegisterPath& regionPath,
+        std::span<const unsigned int> sequenceList, std::span<double> values, size_t offset = 0);
+
+    /** Maximum number of cached accessors of each kind (converted, raw and 2D) */
+    static constexpr size_t maxCachedAccessors = 64;
+
+   private:
+    AliasIndex& getAliasIndex();
+
+    // device name, register path, number of elements, offset
+    using AccessorKey = std::tuple<std::string, std::string, size_t, size_t>;
+
+    template<typename UserType>
+    ChimeraTK::OneDRegisterAccessor<UserType>& getOneDAccessor(const std::string& deviceName,
+        const ChimeraTK::RegisterPath& registerPath, size_t numElements, size_t offset);
+
+    ChimeraTK::TwoDRegisterAccessor<double>& getTwoDAccessor(
+        const std::string& deviceName, const ChimeraTK::RegisterPath& regionPath);
+
+    std::string _explicitDMapFileName;
+    std::string _dmapFileName;
+    std::unique_ptr<AliasIndex> _aliasIndex; // loaded on first use
+    std::map<std::string, ChimeraTK::Device> _devices;
+    std::map<AccessorKey, ChimeraTK::OneDRegisterAccessor<double>> _accessors;
+    std::map<AccessorKey, ChimeraTK::OneDRegisterAccessor<int32_t>> _rawAccessors;
+    std::map<std::pair<std::string, std::string>, ChimeraTK::TwoDRegisterAccessor<double>> _twoDAccessors;
+  };
+
+} // namespace ChimeraTK::command_line_tools
@@ -0,0 +1,96 @@
+/* SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de> */
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+#pragma once
+
+/*
+ * C interface to the mtca4u commands, see ChimeraTK::command_line_tools::Session for the semantics.
+ *
+ * Registers are addressed by module and register name like on the command line, pass "" if there is no module. All
+ * functions except mtca4u_session_create, mtca4u_session_destroy and mtca4u_last_error return 0 on success and -1 on
+ * error. The error message can then be obtained with mtca4u_last_error. It stays valid until the next call with the
+ * same session and is cleared by the next successful call.
+ *
+ * A NULL session, string argument or output pointer is an error. Value buffers may only be NULL if numElements is 0.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mtca4u_session mtca4u_session;
+
+/* Create a session. dmapFileName may be NULL to use the default dmap file lookup. Returns NULL on failure. */
+mtca4u_session* mtca4u_session_create(const char* dmapFileName);
+
+/* Close all devices of the session and free it. */
+void mtca4u_session_destroy(mtca4u_session* session);
+
+/* Close all devices of the session and drop its cached accessors, see Session::clear(). The session stays usable. */
+int mtca4u_session_reset(mtca4u_session* session);
+
+/* Message of the last error of the session, "" if the last call succeeded. Never returns NULL. */
+const char* mtca4u_last_error(const mtca4u_session* session);
+
+/* Description of a register, see ChimeraTK::command_line_tools::RegisterEntry */
+typedef struct mtca4u_register_entry {
+  size_t nDimensions;
+  size_t nChannels;
+  size_t nElements;
+  /* The following fields are only valid if isNumericAddressed is not 0. */
+  int isNumericAddressed;
+  int isSigned;
+  uint32_t width;
+  int32_t nFractionalBits;
+} mtca4u_register_entry;
+
+/*
+ * The list functions write one entry per line into buffer and terminate it with '\0'. requiredSize is set to the
+ * needed buffer size including the terminator. To query the size only, pass NULL as buffer and 0 as bufferSize. A
+ * buffer which is too small is an error.
+ */
+
+/* Devices of the dmap file, one line "<alias>\t<cdd>\t<map file>" per device. */
+int mtca4u_device_list(mtca4u_session* session, char* buffer, size_t bufferSize, size_t* requiredSize);
+
+/* Registers of a device, one line with the register path per register. */
+int mtca4u_register_list(
+    mtca4u_session* session, const char* device, char* buffer, size_t bufferSize, size_t* requiredSize);
+
+/* Description of a single register. */
+int mtca4u_register_info(mtca4u_session* session, const char* device, const char* module, const char* reg,
+    mtca4u_register_entry* info);
+
+/* Number of elements of a register. */
+int mtca4u_register_size(
+    mtca4u_session* session, const char* device, const char* module, const char* reg, size_t* numElements);
+
+/* Read numElements values starting at offset, converted to double. */
+int mtca4u_read(mtca4u_session* session, const char* device, const char* module, const char* reg, size_t offset,
+    double* values, size_t numElements);
+
+/* Read numElements raw values starting at offset, without fixed point conversion. */
+int mtca4u_read_raw(mtca4u_session* session, const char* device, const char* module, const char* reg, size_t offset,
+    int32_t* values, size_t numElements);
+
+/* Write numElements values starting at offset. */
+int mtca4u_write(mtca4u_session* session, const char* device, const char* module, const char* reg, size_t offset,
+    const double* values, size_t numElements);
+
+/* Number of sequences and elements per sequence of a multiplexed data region. */
+int mtca4u_sequence_info(mtca4u_session* session, const char* device, const char* module, const char* region,
+    size_t* numSequences, size_t* numElementsPerSequence);
+
+/*
+ * Read the demultiplexed sequences in sequenceList, numElements elements each, starting at offset. values must hold
+ * numSequences * numElements values and is filled element by element, i.e. values[i * numSequences + j] is element
+ * offset + i of sequence sequenceList[j]. It is an error if numSequences * numElements does not fit into size_t.
+ */
+int mtca4u_read_sequences(mtca4u_session* session, const char* device, const char* module, const char* region,
+    const unsigned int* sequenceList, size_t numSequences, size_t offset, double* values, size_t numElements);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "AliasIndex.h"
+
+#include <ChimeraTK/DMapFileParser.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string_view>
+
+namespace ChimeraTK::command_line_tools {
+
+  /********************************************************************************************************************/
+
+  namespace {
+
+    // Bump the version if the format of the index file changes
+    const std::string indexMagic = "mtca4u-alias-index 2";
+
+    // Backends which can be opened with nothing but their CDD. The map file is the only file they refer to.
+    const std::array<std::string, 6> standaloneBackends{"pci", "xdma", "uio", "dummy", "sharedMemoryDummy", "rebot"};
+
+    /******************************************************************************************************************/
+
+    // Name of the index file for the given absolute dmap file name. Empty if the index file is disabled or there is no
+    // place to store it.
+    std::string indexFileName(const std::string& absoluteDMapFileName) {
+      if(std::getenv("MTCA4U_NO_ALIAS_INDEX") != nullptr) {
+        return "";
+      }
+
+      std::string cacheDir;
+      if(const char* xdgCache = std::getenv("XDG_CACHE_HOME"); xdgCache != nullptr && *xdgCache != '\0') {
+        cacheDir = xdgCache;
+      }
+      else if(const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+        cacheDir = std::string(home) + "/.cache";
+      }
+      else {
+        return "";
+      }
+
+      std::stringstream name;
+      name << cacheDir << "/mtca4u/" << std::hex << std::hash<std::string>{}(absoluteDMapFileName) << ".idx";
+      return name.str();
+    }
+
+    /******************************************************************************************************************/
+
+    // The header identifies the dmap file and the state it had when the index was created. An index is only valid if
+    // its header matches exactly. Empty if the dmap file cannot be stat'ed.
+    std::string indexHeader(const std::string& absoluteDMapFileName) {
+      struct stat dmapStat {};
+      if(::stat(absoluteDMapFileName.c_str(), &dmapStat) != 0) {
+        return "";
+      }
+
+      std::stringstream header;
+      header << indexMagic << "\n"
+             << absoluteDMapFileName << "\n"
+             << dmapStat.st_size << " " << dmapStat.st_mtim.tv_sec << " " << dmapStat.st_mtim.tv_nsec << "\n";
+      return header.str();
+    }
+
+    /******************************************************************************************************************/
+
+    // Convert the CDD from a dmap file into a CDD which can be opened without the dmap file, i.e. make a relative map
+    // file path relative to the dmap file directory. Returns an empty string for backends which might need the dmap
+    // file and for CDDs which are not understood here (nested CDDs, escape sequences).
+    std::string makeCddStandalone(const std::string& cdd, const std::string& dmapDirectory) {
+      if(cdd.size() < 2 || cdd.front() != '(' || cdd.back() != ')') {
+        return "";
+      }
+      if(cdd.find('\\') != std::string::npos || cdd.find('(', 1) != std::string::npos ||
+          cdd.find(')') != cdd.size() - 1) {
+        return "";
+      }
+
+      auto endOfBackendType = cdd.find_first_of(":?)");
+      auto backendType = cdd.substr(1, endOfBackendType - 1);
+      if(std::ranges::find(standaloneBackends, backendType) == standaloneBackends.end()) {
+        return "";
+      }
+
+      auto questionMark = cdd.find('?');
+      if(questionMark == std::string::npos) {
+        return cdd;
+      }
+
+      std::vector<std::string> parameters;
+      std::string parameterString = cdd.substr(questionMark + 1, cdd.size() - questionMark - 2);
+      boost::split(parameters, parameterString, boost::is_any_of("&"));
+
+      auto standaloneCdd = cdd.substr(0, questionMark + 1);
+      for(size_t i = 0; i < parameters.size(); ++i) {
+        if(i > 0) {
+          standaloneCdd += '&';
+        }
+        if(boost::starts_with(parameters[i], "map=") && parameters[i].size() > 4 && parameters[i][4] != '/') {
+          standaloneCdd += "map=";
+          standaloneCdd += dmapDirectory;
+          standaloneCdd += '/';
+          standaloneCdd += parameters[i].substr(4);
+        }
+        else {
+          standaloneCdd += parameters[i];
+        }
+      }
+      standaloneCdd += ')';
+      return standaloneCdd;
+    }
+
+  } // namespace
+
+  /********************************************************************************************************************/
+
+  AliasIndex::AliasIndex(const std::string& dmapFileName) {
+    auto absoluteDMapFileName = boost::filesystem::absolute(dmapFileName).string();
+    auto fileName = indexFileName(absoluteDMapFileName);
+    // Take the header before parsing, so a dmap file modified in between makes the stored index outdated
+    auto header = indexHeader(absoluteDMapFileName);
+
+    if(!fileName.empty() && !header.empty() && readIndexFile(fileName, header)) {
+      _isFromIndexFile = true;
+      return;
+    }
+
+    // The parsed content is used directly, also if the index file cannot be written
+    parseDMapFile(dmapFileName);
+    if(!fileName.empty() && !header.empty()) {
+      writeIndexFile(fileName, header);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  const AliasIndexEntry* AliasIndex::find(const std::string& alias) const {
+    auto it = std::ranges::find(_entries, alias, &AliasIndexEntry::alias);
+    return (it != _entries.end()) ? &*it : nullptr;
+  }
+
+  /********************************************************************************************************************/
+
+  bool AliasIndex::readIndexFile(const std::string& indexFileName, const std::string& expectedHeader) {
+    int fd = ::open(indexFileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+      return false;
+    }
+
+    struct stat indexStat {};
+    if(::fstat(fd, &indexStat) != 0 || static_cast<size_t>(indexStat.st_size) < expectedHeader.size()) {
+      ::close(fd);
+      return false;
+    }
+
+    auto size = static_cast<size_t>(indexStat.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(mapped == MAP_FAILED) {
+      return false;
+    }
+
+    bool valid = false;
+    std::string_view content(static_cast<const char*>(mapped), size);
+    if(content.substr(0, expectedHeader.size()) == expectedHeader) {
+      // Each entry is a line "alias\turi\tmapFileName\tcdd"
+      valid = true;
+      content.remove_prefix(expectedHeader.size());
+      while(!content.empty()) {
+        auto endOfLine = content.find('\n');
+        std::vector<std::string> fields;
+        boost::split(fields, content.substr(0, endOfLine), boost::is_any_of("\t"));
+        if(fields.size() != 4 || endOfLine == std::string_view::npos) {
+          // Incomplete or corrupt, e.g. truncated by a full disk
+          valid = false;
+          break;
+        }
+        _entries.push_back({fields[0], fields[1], fields[2], fields[3]});
+        content.remove_prefix(endOfLine + 1);
+      }
+    }
+
+    ::munmap(mapped, size);
+    if(!valid) {
+      _entries.clear();
+    }
+    return valid;
+  }
+
+  /********************************************************************************************************************/
+
+  void AliasIndex::parseDMapFile(const std::string& dmapFileName) {
+    auto deviceInfoMap = ChimeraTK::DMapFileParser::parse(dmapFileName);
+    auto dmapDirectory = boost::filesystem::absolute(dmapFileName).parent_path().string();
+
+    // Plugin libraries are loaded by DeviceAccess when the dmap file is set, so all devices have to be opened by alias
+    bool hasPlugins = !deviceInfoMap->getPluginLibraries().empty();
+
+    for(auto& deviceInfo : *deviceInfoMap) {
+      // Old style entries with a separate map file column have no standalone CDD
+      std::string cdd;
+      if(!hasPlugins && deviceInfo.mapFileName.empty()) {
+        cdd = makeCddStandalone(deviceInfo.uri, dmapDirectory);
+      }
+      _entries.push_back({deviceInfo.deviceName, deviceInfo.uri, deviceInfo.mapFileName, cdd});
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void AliasIndex::writeIndexFile(const std::string& indexFileName, const std::string& header) const {
+    std::stringstream content;
+    content << header;
+    for(const auto& entry : _entries) {
+      for(const auto* field : {&entry.alias, &entry.uri, &entry.mapFileName, &entry.cdd}) {
+        if(field->find_first_of("\t\n") != std::string::npos) {
+          // Cannot be represented in the index file
+          return;
+        }
+      }
+      content << entry.alias << "\t" << entry.uri << "\t" << entry.mapFileName << "\t" << entry.cdd << "\n";
+    }
+
+    try {
+      // Write to a temporary file and rename it, so concurrent readers never see a partially written index
+      boost::filesystem::path indexPath(indexFileName);
+      boost::filesystem::create_directories(indexPath.parent_path());
+      std::string temporaryFileName = indexFileName + "." + std::to_string(::getpid());
+      {
+        std::ofstream indexFile(temporaryFileName, std::ios::trunc);
+        indexFile << content.str();
+        if(!indexFile.good()) {
+          indexFile.close();
+          boost::filesystem::remove(temporaryFileName);
+          return;
+        }
+      }
+      boost::filesystem::rename(temporaryFileName, indexPath);
+    }
+    catch(std::exception&) {
+      // The index file is only a cache. It is not written if the cache directory cannot be written.
+    }
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK::command_line_tools
@@ -0,0 +1,522 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "Commands.h"
+#include "version.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+std::vector<Command> vectorOfCommands = {{"help", printHelp, "Prints the help text", "\t\t\t\t\t"},
+    {"version", getVersion, "Prints the tools version", "\t\t\t\t"},
+    {"info", getInfo, "Prints all devices", "\t\t\t\t\t"},
+    {"device_info", getDeviceInfo, "Prints the register list of a device", "Board\t\t\t"},
+    {"register_info", getRegisterInfo, "Prints the info of a register", "Board Module Register \t\t"},
+    {"register_size", getRegisterSize, "Prints the size of a register", "Board Module Register \t\t"},
+    {"read", readRegister, "Read data from Board", "\tBoard Module Register [offset] [elements] [raw | hex]"},
+    {"write", writeRegister, "Write data to Board", "\tBoard Module Register Value [offset]\t"},
+    {"read_dma_raw", readDmaRawData,
+        "Read raw 32 bit values from DMA registers without Fixed point "
+        "conversion",
+        "Board Module Register [offset] [elements] [raw | hex]\t"},
+    {"read_seq", readMultiplexedData,
+        "Get demultiplexed data sequences from a memory region (containing "
+        "muxed data sequences)",
+        "Board Module DataRegionName [\"sequenceList\"] [Offset] "
+        "[numElements]"}};
+
+/**********************************************************************************************************************/
+
+// Implementations
+
+/**
+ * @brief PrintHelp shows the help text on the console
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ */
+void printHelp(Session& /*session*/, unsigned int /*argc*/, const char* /*argv*/[]) {
+  std::cout << std::endl
+            << "mtca4u command line tools, version " << ChimeraTK::command_line_tools::VERSION << "\n"
+            << std::endl;
+  std::cout << "Available commands are:" << std::endl << std::endl;
+
+  for(auto& command : vectorOfCommands) {
+    std::cout << "  " << command.name << "\t" << command.example << "\t" << command.description << std::endl;
+  }
+  std::cout << std::endl << "Options (before the command):" << std::endl << std::endl;
+  std::cout << "  --dmap\tFile\t\t\t\tUse the given dmap file (default: $MTCA4U_DMAP_FILE or the dmap file in the "
+               "current directory)"
+            << std::endl;
+  std::cout << std::endl
+            << std::endl
+            << "For further help or bug reports please contact chimeratk_support@desy.de" << std::endl
+            << std::endl;
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * @brief getVersion shows the command line tools version
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ */
+void getVersion(Session& /*session*/, unsigned int /*argc*/, const char* /*argv*/[]) {
+  std::cout << ChimeraTK::command_line_tools::VERSION << std::endl;
+}
+
+/**
+ * @brief getInfo shows the device information
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ */
+void getInfo(Session& session, unsigned int /*argc*/, const char* /*argv*/[]) {
+  if(session.getDMapFileName().empty()) {
+    std::cout << "No dmap file found. No device information available." << std::endl;
+    return;
+  }
+
+  auto devices = session.getDeviceList();
+
+  std::cout << std::endl << "Available devices: " << std::endl << std::endl;
+  std::cout << "Name\tDevice\t\t\tMap-File\t\t\tFirmware\tRevision" << std::endl;
+
+  for(auto& device : devices) {
+    std::cout << device.alias << "\t" << device.cdd
+              << "\t\t"
+              // mapFileName might be empty
+              << (device.mapFileName.empty() ? "na" : device.mapFileName)
+              << "\t"
+              // For compatibility: print na. The registers WORD_FIRMWARE and WORD_REVISION
+              // don't exist in map files any more, so no one can really have used this feature.
+              // It breaks abstraction anyway, so we just disable it, but keep the format for compatibility.
+              << "na"
+              << "\t\t"
+              << "na" << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * @brief getDeviceInfo shows the device information
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ */
+void getDeviceInfo(Session& session, unsigned int argc, const char* argv[]) {
+  if(argc < 1) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+
+  auto registers = session.getRegisterList(argv[0]);
+
+  std::cout << "Name\t\tElements\tSigned\t\tBits\t\tFractional_Bits\t\tDescription" << std::endl;
+
+  unsigned int n2DChannels = 0;
+  for(const auto& reg : registers) {
+    if(reg.nDimensions == 2) {
+      ++n2DChannels;
+      continue;
+    }
+    std::cout << reg.name.getWithAltSeparator() << "\t";
+    std::cout << reg.nElements << "\t\t";
+    if(reg.isNumericAddressed) {
+      // ToDo: Add Description and handle multiple channels properly
+      std::cout << reg.signedFlag << "\t\t";
+      std::cout << reg.width << "\t\t" << reg.nFractionalBits << "\t\t\t ";
+    }
+    std::cout << std::endl;
+  }
+
+  if(n2DChannels > 0) {
+    std::cout << "\n2D registers\n"
+              << "Name\tnChannels\tnElementsPerChannel\n";
+    for(const auto& reg : registers) {
+      if(reg.nDimensions != 2) {
+        continue;
+      }
+      std::cout << reg.name.getWithAltSeparator() << "\t";
+      std::cout << reg.nChannels << "\t\t";
+      std::cout << reg.nElements << std::endl;
+    }
+  }
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * @brief getRegisterInfo shows the register information
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ */
+void getRegisterInfo(Session& session, unsigned int argc, const char* argv[]) {
+  if(argc < 3) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+
+  auto regInfo = session.getRegisterInfo(argv[0], std::string(argv[1]) + "/" + argv[2]);
+
+  std::cout << "Name\t\tElements\tSigned\t\tBits\t\tFractional_Bits\t\tDescription" << std::endl;
+  std::cout << regInfo.name.getWithAltSeparator() << "\t" << regInfo.nElements;
+
+  if(regInfo.isNumericAddressed) {
+    // ToDo: Add Description and handle multiple channels properly
+    std::cout << "\t\t" << regInfo.signedFlag << "\t\t";
+    std::cout << regInfo.width << "\t\t" << regInfo.nFractionalBits << "\t\t\t " << std::endl;
+  }
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * getRegisterInfo prints the size of a register (number of elements).
+ * \todo FIXME: For 2D- registers it is the size of one channel.
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ */
+void getRegisterSize(Session& session, unsigned int argc, const char* argv[]) {
+  if(argc < 3) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+
+  std::cout << session.getRegisterSize(argv[0], std::string(argv[1]) + "/" + argv[2]) << std::endl;
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * @brief readRegister
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ * Parameter: device, module, register, [offset], [elements], [cmode]
+ */
+void readRegister(Session& session, unsigned int argc, const char* argv[]) {
+  const unsigned int maxCmdArgs = 6;
+
+  if(argc < 3) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+  // validate argc
+  argc = (argc > maxCmdArgs) ? maxCmdArgs : argc;
+  std::vector<std::string> argList = createArgList(argc, argv, maxCmdArgs);
+
+  readRegisterInternal(session, argList);
+}
+
+/**********************************************************************************************************************/
+
+void readRegisterInternal(Session& session, const std::vector<std::string>& argList) {
+  const unsigned int pp_device = 0, pp_module = 1, pp_register = 2, pp_offset = 3, pp_elements = 4, pp_cmode = 5;
+
+  const auto& deviceName = argList[pp_device];
+
+  auto registerPath = ChimeraTK::RegisterPath(argList[pp_module]) / argList[pp_register];
+
+  uint offset = stringToUIntWithZeroDefault(argList[pp_offset]);
+  uint numElements = stringToUIntWithZeroDefault(argList[pp_elements]);
+  std::string cmode = extractDisplayMode(argList[pp_cmode]);
+
+  // getNumberOfElements() resolves numElements == 0 to the register size and checks the requested range
+
+  // Read as raw values
+  if((cmode == "raw") || (cmode == "hex")) {
+    std::vector<int32_t> values(session.getNumberOfElements<int32_t>(deviceName, registerPath, numElements, offset));
+    session.readRaw(deviceName, registerPath, values, offset);
+    if(cmode == "hex") {
+      std::cout << std::hex;
+    }
+    else {
+      std::cout << std::fixed;
+    }
+    for(auto value : values) {
+      std::cout << static_cast<uint32_t>(value) << "\n";
+    }
+  }
+  else { // Read with automatic conversion to double
+    std::vector<double> values(session.getNumberOfElements<double>(deviceName, registerPath, numElements, offset));
+    session.read(deviceName, registerPath, values, offset);
+    std::cout << std::scientific << std::setprecision(8);
+    for(auto value : values) {
+      std::cout << value << "\n";
+    }
+  }
+  std::cout << std::flush;
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * @brief writeRegister
+ *
+ * @param[in] argc Number of additional parameter
+ * @param[in] argv Pointer to additional parameter
+ *
+ * Parameter: device, module, register, value, [offset]
+ */
+void writeRegister(Session& session, unsigned int argc, const char* argv[]) {
+  const unsigned int pp_device = 0, pp_module = 1, pp_register = 2, pp_value = 3, pp_offset = 4;
+
+  if(argc < 4) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+
+  auto registerPath = ChimeraTK::RegisterPath(argv[pp_module]) / argv[pp_register];
+
+  const uint32_t offset = (argc > pp_offset) ? std::stoul(argv[pp_offset]) : 0;
+
+  std::vector<std::string> vS;
+  boost::split(vS, argv[pp_value], boost::is_any_of("\t "));
+
+  // Check the device, register and the requested range before converting the values
+  session.getNumberOfElements(argv[pp_device], registerPath, vS.size(), offset);
+
+  std::vector<double> values(vS.size());
+  try {
+    std::ranges::transform(vS, values.begin(), [](const std::string& s) { return stod(s); });
+  }
+  catch(std::invalid_argument&) {
+    throw ChimeraTK::logic_error("Could not convert parameter to double."); // + d + " to double: " +
+                                                                            // ex.what(), 3);
+  }
+  catch(std::out_of_range&) {
+    throw ChimeraTK::logic_error("Could not convert parameter to double."); // + d + " to double: " +
+                                                                            // ex.what(), 3);
+  }
+
+  session.write(argv[pp_device], registerPath, values, offset);
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * @brief readRawDmaData
+ *
+ * @param[in] nlhs Number of left hand side parameter
+ * @param[inout] phls Pointer to the left hand side parameter
+ *
+ * Parameter: device, register, [offset], [elements], [display_mode]
+ */
+void readDmaRawData(Session& session, unsigned int argc, const char* argv[]) {
+  const unsigned int pp_cmode = 5;
+  const unsigned int maxCmdArgs = 6;
+
+  if(argc < 3) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+  // validate argc
+  argc = (argc > maxCmdArgs) ? maxCmdArgs : argc;
+  std::vector<std::string> argList = createArgList(argc, argv, maxCmdArgs);
+
+  if(argList.size() <= pp_cmode || argList[pp_cmode].empty()) {
+    argList.resize(pp_cmode + 1);
+    argList[pp_cmode] = "raw";
+  }
+
+  readRegisterInternal(session, argList);
+}
+
+/**********************************************************************************************************************/
+
+void readMultiplexedData(Session& session, unsigned int argc, const char* argv[]) {
+  const unsigned int maxCmdArgs = 6;
+  const unsigned int pp_deviceName = 0, pp_module = 1, pp_register = 2, pp_seqList = 3, pp_offset = 4, pp_elements = 5;
+  if(argc < 3) {
+    throw ChimeraTK::logic_error("Not enough input arguments.");
+  }
+
+  // validate argc
+  argc = (argc > maxCmdArgs) ? maxCmdArgs : argc;
+  std::vector<std::string> argList = createArgList(argc, argv, maxCmdArgs);
+
+  auto regionPath = ChimeraTK::RegisterPath(argList[pp_module]) / argList[pp_register];
+  auto sequenceInfo = session.getSequenceInfo(argList[pp_deviceName], regionPath);
+  uint sequenceLength = sequenceInfo.nElementsPerSequence;
+  uint numSequences = sequenceInfo.nSequences;
+  std::vector<uint> seqList = extractSequenceList(argList[pp_seqList], numSequences);
+  uint maxOffset = sequenceLength - 1;
+  uint offset = extractOffset(argList[pp_offset], maxOffset);
+
+  uint numElements = extractNumElements(argList[pp_elements], offset, sequenceLength);
+  if(numElements == 0) {
+    return;
+  }
+
+  std::vector<double> values(seqList.size() * numElements);
+  session.readSequences(argList[pp_deviceName], regionPath, seqList, values, offset);
+
+  printSeqList(values, seqList.size(), numElements);
+}
+
+/**********************************************************************************************************************/
+
+// expects the values as delivered by Session::readSequences()
+void printSeqList(std::vector<double> const& values, size_t numSequencesInList, uint elements) {
+  for(uint i = 0; i < elements; i++) {
+    for(size_t j = 0; j < numSequencesInList; j++) {
+      std::cout << values[i * numSequencesInList + j] << "\t";
+    }
+    std::cout << "\n";
+  }
+  std::cout << std::flush;
+}
+
+std::vector<uint> extractSequenceList(std::string const& list, uint numSequences) {
+  if(list.empty()) {
+    return createListWithAllSequences(numSequences);
+  }
+
+  std::stringstream listOfSeqNumbers(list);
+  std::string tmpString;
+  std::vector<uint> seqList;
+  seqList.reserve(numSequences);
+
+  uint tmpSeqNum;
+  try {
+    while(std::getline(listOfSeqNumbers, tmpString, ' ')) {
+      tmpSeqNum = std::stoul(tmpString);
+
+      if(tmpSeqNum >= numSequences) {
+        std::stringstream ss;
+        ss << "seqNum invalid. Valid seqNumbers are in the range [0, " << (numSequences - 1) << "]";
+        throw ChimeraTK::logic_error(ss.str());
+      }
+
+      seqList.push_back(tmpSeqNum);
+    }
+    return seqList;
+  }
+  catch(std::invalid_argument&) {
+    std::stringstream ss;
+    ss << "Could not convert sequence List";
+    throw ChimeraTK::logic_error(ss.str()); // + d + " to double: " + ex.what(), 3);
+  }
+}
+
+/**********************************************************************************************************************/
+
+std::vector<std::string> createArgList(uint argc, const char* argv[], uint maxArgs) {
+  // pre-condition argc <= maxArgs is assumed when invoking this method.
+  std::vector<std::string> listOfCmdArguments;
+  listOfCmdArguments.reserve(maxArgs);
+
+  for(size_t i = 0; i < argc; i++) {
+    listOfCmdArguments.emplace_back(argv[i]);
+  }
+
+  // rest of the arguments provided represented as empty std::strings
+  for(size_t i = argc; i < maxArgs; i++) {
+    listOfCmdArguments.emplace_back("");
+  }
+  return listOfCmdArguments;
+}
+
+/**********************************************************************************************************************/
+
+uint extractOffset(const std::string& userEnteredOffset, uint maxOffset) {
+  // TODO: try avoid code duplication with extractNumElements
+  uint offset;
+  if(userEnteredOffset.empty()) {
+    offset = 0;
+  }
+  else {
+    try {
+      offset = std::stoul(userEnteredOffset);
+    }
+    catch(std::invalid_argument&) {
+      throw ChimeraTK::logic_error("Could not convert Offset");
+    }
+  }
+
+  if(offset > maxOffset) {
+    throw ChimeraTK::logic_error("Offset exceed register size.");
+  }
+
+  return offset;
+}
+
+/**********************************************************************************************************************/
+
+uint extractNumElements(const std::string& userEnteredValue, uint validOffset, uint maxElements) {
+  uint numElements;
+  try {
+    if(userEnteredValue.empty()) {
+      numElements = maxElements - validOffset;
+    }
+    else {
+      numElements = std::stoul(userEnteredValue);
+    }
+  }
+  catch(std::invalid_argument&) {
+    throw ChimeraTK::logic_error("Could not convert numElements to return");
+  }
+  if(numElements > (maxElements - validOffset)) {
+    throw ChimeraTK::logic_error("Data size exceed register size.");
+  }
+  return numElements;
+}
+
+/**********************************************************************************************************************/
+
+uint stringToUIntWithZeroDefault(const std::string& userEnteredValue) {
+  // return 0 if the std::string is empty (0 means the whole register or no offset)
+  if(userEnteredValue.empty()) {
+    return 0;
+  }
+
+  // Just extract the number and convert a possible conversion exception to
+  // an ChimeraTK::logic_error with proper error message
+  uint numElements;
+  try {
+    numElements = std::stoul(userEnteredValue);
+  }
+  catch(std::invalid_argument&) {
+    throw ChimeraTK::logic_error("Could not convert numElements or offset to a valid number.");
+  }
+
+  return numElements;
+}
+
+/**********************************************************************************************************************/
+
+std::string extractDisplayMode(const std::string& displayMode) {
+  if(displayMode.empty()) {
+    return "double";
+  } // default
+
+  if((displayMode != "raw") && (displayMode != "hex") && (displayMode != "double")) {
+    throw ChimeraTK::logic_error("Invalid display mode; Use raw | hex");
+  }
+  return displayMode;
+}
+
+/**********************************************************************************************************************/
+
+std::vector<uint> createListWithAllSequences(uint numSequences) {
+  std::vector<uint> seqList(numSequences);
+  for(uint index = 0; index < numSequences; ++index) {
+    seqList[index] = index;
+  }
+  return seqList;
+}
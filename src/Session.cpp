@@ -0,0 +1,366 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "Session.h"
+
+#include "AliasIndex.h"
+
+#include <ChimeraTK/NumericAddressedRegisterCatalogue.h>
+#include <ChimeraTK/Utilities.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace ChimeraTK::command_line_tools {
+
+  /********************************************************************************************************************/
+
+  std::string findDMapFile(const std::string& explicitDMapFileName) {
+    std::string selectedDMapFileName = explicitDMapFileName;
+    if(selectedDMapFileName.empty()) {
+      const char* fromEnvironment = std::getenv("MTCA4U_DMAP_FILE");
+      selectedDMapFileName = (fromEnvironment != nullptr) ? fromEnvironment : "";
+    }
+    if(!selectedDMapFileName.empty()) {
+      if(!boost::filesystem::is_regular_file(selectedDMapFileName)) {
+        throw ChimeraTK::logic_error("dmap file '" + selectedDMapFileName + "' does not exist.");
+      }
+      return selectedDMapFileName;
+    }
+
+    // CommandLineTools.dmap is taken whenever it is present, so the directory does not have to be scanned.
+    if(boost::filesystem::is_regular_file("CommandLineTools.dmap")) {
+      return "./CommandLineTools.dmap";
+    }
+
+    std::vector<boost::filesystem::path> dmapFileNames;
+    for(auto& dirEntry : boost::filesystem::directory_iterator(".")) {
+      if(dirEntry.path().extension() == ".dmap") {
+        dmapFileNames.push_back(dirEntry.path());
+      }
+    }
+    // No DMap file found. Do not throw here but return an empty std::string.
+    // We can print a much nicer error message in the context where we know the device alias.
+    if(dmapFileNames.empty()) {
+      return "";
+    }
+    if(dmapFileNames.size() > 1) {
+      // search for a file named CommandLineTools.dmap and return it. Only throw if not found.
+      for(auto& dmapFileName : dmapFileNames) {
+        if(dmapFileName.stem() == "CommandLineTools") {
+          return dmapFileName.string();
+        }
+      }
+
+      throw ChimeraTK::logic_error("Found more than one dmap file. Name one of them 'CommandLineTools.dmap' (or create a "
+                                   "symlink) so I know which one to take.");
+    }
+
+    return dmapFileNames.front().string();
+  }
+
+  /********************************************************************************************************************/
+
+  Session::Session(std::string dmapFileName) : _explicitDMapFileName(std::move(dmapFileName)) {}
+
+  Session::~Session() = default;
+  Session::Session(Session&&) noexcept = default;
+  Session& Session::operator=(Session&&) noexcept = default;
+
+  /********************************************************************************************************************/
+
+  const std::string& Session::getDMapFileName() {
+    // Only a found file is remembered, so a dmap file created later is still picked up
+    if(_dmapFileName.empty()) {
+      _dmapFileName = findDMapFile(_explicitDMapFileName);
+    }
+    return _dmapFileName;
+  }
+
+  /********************************************************************************************************************/
+
+  AliasIndex& Session::getAliasIndex() {
+    if(!_aliasIndex) {
+      // The caller has checked that there is a dmap file
+      _aliasIndex = std::make_unique<AliasIndex>(getDMapFileName());
+    }
+    return *_aliasIndex;
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<DeviceEntry> Session::getDeviceList() {
+    if(getDMapFileName().empty()) {
+      throw ChimeraTK::logic_error("No dmap file found. No device information available.");
+    }
+
+    std::vector<DeviceEntry> devices;
+    for(const auto& entry : getAliasIndex().getEntries()) {
+      devices.push_back({entry.alias, entry.uri, entry.mapFileName});
+    }
+    return devices;
+  }
+
+  /********************************************************************************************************************/
+
+  void Session::clear() {
+    // The accessors have to go first, they keep the backends alive
+    _accessors.clear();
+    _rawAccessors.clear();
+    _twoDAccessors.clear();
+    for(auto& [name, device] : _devices) {
+      device.close();
+    }
+    _devices.clear();
+    _aliasIndex.reset();
+  }
+
+  /********************************************************************************************************************/
+
+  ChimeraTK::Device& Session::getDevice(const std::string& deviceName) {
+    auto it = _devices.find(deviceName);
+    if(it != _devices.end()) {
+      // Recover from a previous runtime_error. The accessors of the device stay valid.
+      if(!it->second.isFunctional()) {
+        it->second.open();
+      }
+      return it->second;
+    }
+
+    bool isSdm = (deviceName.substr(0, 6) == "sdm://"); // starts with sdm://
+    bool isCdd = (!deviceName.empty() && (deviceName.front() == '(') &&
+        (deviceName.back() == ')')); // starts with '(' and end with ')' = Chimera Device Descriptor
+
+    ChimeraTK::Device device;
+    if(isSdm || isCdd) {
+      // For SDM URIs and CDDs the dmap file name can be empty
+      device.open(deviceName);
+    }
+    else {
+      /* If the device name is not an sdm and not a cdd, it is an alias which has to be resolved with the dmap file.
+         Try to determine it if not given. */
+      const auto& dmapFileName = getDMapFileName();
+      if(dmapFileName.empty()) {
+        throw ChimeraTK::logic_error("No dmap file found to resolve alias name '" + deviceName +
+            "'. Provide a dmap file or use a ChimeraTK Device Descriptor!");
+      }
+
+      const auto* entry = getAliasIndex().find(deviceName);
+      if(entry != nullptr && !entry->cdd.empty()) {
+        // Does not need the dmap file, which saves parsing it again in DeviceAccess
+        device.open(entry->cdd);
+      }
+      else {
+        // Unknown aliases are also passed on, so the error message comes from DeviceAccess
+        ChimeraTK::setDMapFilePath(dmapFileName);
+        device.open(deviceName);
+      }
+    }
+
+    return _devices.emplace(deviceName, std::move(device)).first->second;
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  ChimeraTK::OneDRegisterAccessor<UserType>& Session::getOneDAccessor(
+      const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath, size_t numElements, size_t offset) {
+    auto& accessors = [&]() -> auto& {
+      if constexpr(std::is_same_v<UserType, int32_t>) {
+        return _rawAccessors;
+      }
+      else {
+        return _accessors;
+      }
+    }();
+
+    // Always get the device, so it is reopened if necessary
+    auto& device = getDevice(deviceName);
+
+    AccessorKey key{deviceName, registerPath, numElements, offset};
+    auto it = accessors.find(key);
+    if(it != accessors.end()) {
+      return it->second;
+    }
+
+    ChimeraTK::AccessModeFlags flags{};
+    if constexpr(std::is_same_v<UserType, int32_t>) {
+      flags = {ChimeraTK::AccessMode::raw};
+    }
+    auto accessor = device.getOneDRegisterAccessor<UserType>(registerPath, numElements, offset, flags);
+
+    // Bound the memory for callers which use many different ranges. Dropping all is good enough, typical callers
+    // only use a few accessors.
+    if(accessors.size() + 2 > maxCachedAccessors) {
+      accessors.clear();
+    }
+
+    // Also store it under the resolved size, so a later access with the actual number of elements finds it
+    if(numElements == 0) {
+      accessors.emplace(AccessorKey{deviceName, registerPath, accessor.getNElements(), offset}, accessor);
+    }
+    return accessors.emplace(key, accessor).first->second;
+  }
+
+  /********************************************************************************************************************/
+
+  ChimeraTK::TwoDRegisterAccessor<double>& Session::getTwoDAccessor(
+      const std::string& deviceName, const ChimeraTK::RegisterPath& regionPath) {
+    auto& device = getDevice(deviceName);
+
+    auto key = std::make_pair(deviceName, std::string(regionPath));
+    auto it = _twoDAccessors.find(key);
+    if(it != _twoDAccessors.end()) {
+      return it->second;
+    }
+
+    auto accessor = device.getTwoDRegisterAccessor<double>(regionPath);
+    if(_twoDAccessors.size() >= maxCachedAccessors) {
+      _twoDAccessors.clear();
+    }
+    return _twoDAccessors.emplace(key, accessor).first->second;
+  }
+
+  /********************************************************************************************************************/
+
+  namespace {
+    RegisterEntry makeRegisterEntry(const ChimeraTK::BackendRegisterInfoBase& regInfo) {
+      RegisterEntry entry{regInfo.getRegisterName(), regInfo.getNumberOfDimensions(), regInfo.getNumberOfChannels(),
+          regInfo.getNumberOfElements(), false, false, 0, 0};
+
+      const auto* numericInfo = dynamic_cast<const ChimeraTK::NumericAddressedRegisterInfo*>(&regInfo);
+      if(numericInfo && !numericInfo->channels.empty()) {
+        entry.isNumericAddressed = true;
+        entry.signedFlag = numericInfo->channels.front().signedFlag;
+        entry.width = numericInfo->channels.front().width;
+        entry.nFractionalBits = numericInfo->channels.front().nFractionalBits;
+      }
+      return entry;
+    }
+  } // namespace
+
+  /********************************************************************************************************************/
+
+  std::vector<RegisterEntry> Session::getRegisterList(const std::string& deviceName) {
+    auto catalog = getDevice(deviceName).getRegisterCatalogue();
+
+    std::vector<RegisterEntry> registers;
+    for(const auto& reg : catalog) {
+      registers.push_back(makeRegisterEntry(reg));
+    }
+    return registers;
+  }
+
+  /********************************************************************************************************************/
+
+  RegisterEntry Session::getRegisterInfo(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath) {
+    auto regInfo = getDevice(deviceName).getRegisterCatalogue().getRegister(registerPath);
+    return makeRegisterEntry(regInfo.getImpl());
+  }
+
+  /********************************************************************************************************************/
+
+  size_t Session::getRegisterSize(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath) {
+    return getDevice(deviceName).getRegisterCatalogue().getRegister(registerPath).getNumberOfElements();
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  size_t Session::getNumberOfElements(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+      size_t numElements, size_t offset) {
+    return getOneDAccessor<UserType>(deviceName, registerPath, numElements, offset).getNElements();
+  }
+
+  template size_t Session::getNumberOfElements<double>(const std::string&, const ChimeraTK::RegisterPath&, size_t,
+      size_t);
+  template size_t Session::getNumberOfElements<int32_t>(const std::string&, const ChimeraTK::RegisterPath&, size_t,
+      size_t);
+
+  /********************************************************************************************************************/
+
+  void Session::read(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+      std::span<double> values, size_t offset) {
+    // Requesting 0 elements would give the whole register
+    if(values.empty()) {
+      return;
+    }
+    auto& accessor = getOneDAccessor<double>(deviceName, registerPath, values.size(), offset);
+    accessor.read();
+    std::copy(accessor.begin(), accessor.end(), values.begin());
+  }
+
+  /********************************************************************************************************************/
+
+  void Session::readRaw(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+      std::span<int32_t> values, size_t offset) {
+    if(values.empty()) {
+      return;
+    }
+    auto& accessor = getOneDAccessor<int32_t>(deviceName, registerPath, values.size(), offset);
+    accessor.read();
+    std::copy(accessor.begin(), accessor.end(), values.begin());
+  }
+
+  /********************************************************************************************************************/
+
+  void Session::write(const std::string& deviceName, const ChimeraTK::RegisterPath& registerPath,
+      std::span<const double> values, size_t offset) {
+    if(values.empty()) {
+      return;
+    }
+    auto& accessor = getOneDAccessor<double>(deviceName, registerPath, values.size(), offset);
+    std::ranges::copy(values, accessor.begin());
+    accessor.write();
+  }
+
+  /********************************************************************************************************************/
+
+  SequenceInfo Session::getSequenceInfo(const std::string& deviceName, const ChimeraTK::RegisterPath& regionPath) {
+    auto& accessor = getTwoDAccessor(deviceName, regionPath);
+    return {accessor.getNChannels(), accessor.getNElementsPerChannel()};
+  }
+
+  /********************************************************************************************************************/
+
+  void Session::readSequences(const std::string& deviceName, const ChimeraTK::RegisterPath& regionPath,
+      std::span<const unsigned int> sequenceList, std::span<double> values, size_t offset) {
+    auto& accessor = getTwoDAccessor(deviceName, regionPath);
+    if(sequenceList.empty()) {
+      return;
+    }
+
+    if(values.size() % sequenceList.size() != 0) {
+      throw ChimeraTK::logic_error("Buffer size is not a multiple of the number of requested sequences.");
+    }
+
+    size_t numSequences = accessor.getNChannels();
+    for(auto seqNum : sequenceList) {
+      if(seqNum >= numSequences) {
+        std::stringstream ss;
+        ss << "seqNum invalid. Valid seqNumbers are in the range [0, " << (numSequences - 1) << "]";
+        throw ChimeraTK::logic_error(ss.str());
+      }
+    }
+
+    size_t numElements = values.size() / sequenceList.size();
+    if(offset + numElements > accessor.getNElementsPerChannel()) {
+      throw ChimeraTK::logic_error("Data size exceed register size.");
+    }
+
+    accessor.read();
+    for(size_t i = 0; i < numElements; ++i) {
+      for(size_t j = 0; j < sequenceList.size(); ++j) {
+        values[i * sequenceList.size() + j] = accessor[sequenceList[j]][offset + i];
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK::command_line_tools
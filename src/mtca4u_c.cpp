@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mtca4u_c.h"
+
+#include "Session.h"
+
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+
+struct mtca4u_session {
+  explicit mtca4u_session(const char* dmapFileName) : session(dmapFileName != nullptr ? dmapFileName : "") {}
+
+  ChimeraTK::command_line_tools::Session session;
+  std::string lastError;
+};
+
+/**********************************************************************************************************************/
+
+namespace {
+
+  // Run the function and convert exceptions into the return code and the last error of the session
+  template<typename Function>
+  int callAndCatch(mtca4u_session* session, Function function) {
+    if(session == nullptr) {
+      return -1;
+    }
+    try {
+      function(session->session);
+      session->lastError.clear();
+      return 0;
+    }
+    catch(std::exception& e) {
+      session->lastError = e.what();
+    }
+    catch(...) {
+      session->lastError = "Unknown exception";
+    }
+    return -1;
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename T>
+  T* checkPointer(T* pointer, const char* argumentName) {
+    if(pointer == nullptr) {
+      throw ChimeraTK::logic_error(std::string("Argument '") + argumentName + "' must not be NULL.");
+    }
+    return pointer;
+  }
+
+  /********************************************************************************************************************/
+
+  // Buffers may be NULL if they are empty
+  template<typename T>
+  void checkBuffer(T* buffer, size_t numElements, const char* argumentName = "values") {
+    if(numElements > 0) {
+      checkPointer(buffer, argumentName);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  ChimeraTK::RegisterPath makeRegisterPath(const char* module, const char* reg) {
+    return ChimeraTK::RegisterPath(checkPointer(module, "module")) / checkPointer(reg, "reg");
+  }
+
+  /********************************************************************************************************************/
+
+  void copyToBuffer(const std::string& list, char* buffer, size_t bufferSize, size_t* requiredSize) {
+    checkPointer(requiredSize, "requiredSize");
+    *requiredSize = list.size() + 1;
+    if(buffer == nullptr && bufferSize == 0) {
+      return;
+    }
+    checkPointer(buffer, "buffer");
+    if(bufferSize < *requiredSize) {
+      throw ChimeraTK::logic_error("Buffer too small, " + std::to_string(*requiredSize) + " bytes are required.");
+    }
+    std::memcpy(buffer, list.c_str(), *requiredSize);
+  }
+
+} // namespace
+
+/**********************************************************************************************************************/
+
+mtca4u_session* mtca4u_session_create(const char* dmapFileName) {
+  // No exception must cross the C interface, also not from the constructors
+  try {
+    return new mtca4u_session(dmapFileName);
+  }
+  catch(...) {
+    return nullptr;
+  }
+}
+
+/**********************************************************************************************************************/
+
+void mtca4u_session_destroy(mtca4u_session* session) {
+  delete session;
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_session_reset(mtca4u_session* session) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) { s.clear(); });
+}
+
+/**********************************************************************************************************************/
+
+const char* mtca4u_last_error(const mtca4u_session* session) {
+  if(session == nullptr) {
+    return "Invalid session (NULL).";
+  }
+  return session->lastError.c_str();
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_device_list(mtca4u_session* session, char* buffer, size_t bufferSize, size_t* requiredSize) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    std::string list;
+    for(auto& device : s.getDeviceList()) {
+      list += device.alias + "\t" + device.cdd + "\t" + device.mapFileName + "\n";
+    }
+    copyToBuffer(list, buffer, bufferSize, requiredSize);
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_register_list(
+    mtca4u_session* session, const char* device, char* buffer, size_t bufferSize, size_t* requiredSize) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    std::string list;
+    for(auto& reg : s.getRegisterList(checkPointer(device, "device"))) {
+      list += std::string(reg.name) + "\n";
+    }
+    copyToBuffer(list, buffer, bufferSize, requiredSize);
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_register_info(mtca4u_session* session, const char* device, const char* module, const char* reg,
+    mtca4u_register_entry* info) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkPointer(info, "info");
+    auto entry = s.getRegisterInfo(checkPointer(device, "device"), makeRegisterPath(module, reg));
+    info->nDimensions = entry.nDimensions;
+    info->nChannels = entry.nChannels;
+    info->nElements = entry.nElements;
+    info->isNumericAddressed = entry.isNumericAddressed;
+    info->isSigned = entry.signedFlag;
+    info->width = entry.width;
+    info->nFractionalBits = entry.nFractionalBits;
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_register_size(
+    mtca4u_session* session, const char* device, const char* module, const char* reg, size_t* numElements) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkPointer(numElements, "numElements");
+    *numElements = s.getRegisterSize(checkPointer(device, "device"), makeRegisterPath(module, reg));
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_read(mtca4u_session* session, const char* device, const char* module, const char* reg, size_t offset,
+    double* values, size_t numElements) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkBuffer(values, numElements);
+    s.read(checkPointer(device, "device"), makeRegisterPath(module, reg), {values, numElements}, offset);
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_read_raw(mtca4u_session* session, const char* device, const char* module, const char* reg, size_t offset,
+    int32_t* values, size_t numElements) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkBuffer(values, numElements);
+    s.readRaw(checkPointer(device, "device"), makeRegisterPath(module, reg), {values, numElements}, offset);
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_write(mtca4u_session* session, const char* device, const char* module, const char* reg, size_t offset,
+    const double* values, size_t numElements) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkBuffer(values, numElements);
+    s.write(checkPointer(device, "device"), makeRegisterPath(module, reg), {values, numElements}, offset);
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_sequence_info(mtca4u_session* session, const char* device, const char* module, const char* region,
+    size_t* numSequences, size_t* numElementsPerSequence) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkPointer(numSequences, "numSequences");
+    checkPointer(numElementsPerSequence, "numElementsPerSequence");
+    auto info = s.getSequenceInfo(checkPointer(device, "device"), makeRegisterPath(module, region));
+    *numSequences = info.nSequences;
+    *numElementsPerSequence = info.nElementsPerSequence;
+  });
+}
+
+/**********************************************************************************************************************/
+
+int mtca4u_read_sequences(mtca4u_session* session, const char* device, const char* module, const char* region,
+    const unsigned int* sequenceList, size_t numSequences, size_t offset, double* values, size_t numElements) {
+  return callAndCatch(session, [&](ChimeraTK::command_line_tools::Session& s) {
+    checkBuffer(sequenceList, numSequences, "sequenceList");
+    if(numSequences > 0 && numElements > std::numeric_limits<size_t>::max() / numSequences) {
+      throw ChimeraTK::logic_error("numSequences * numElements exceeds the addressable size.");
+    }
+    checkBuffer(values, numSequences * numElements);
+    s.readSequences(checkPointer(device, "device"), makeRegisterPath(module, region), {sequenceList, numSequences},
+        {values, numSequences * numElements}, offset);
+  });
+}
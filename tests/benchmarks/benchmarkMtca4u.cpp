@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/*
+ * Times the hot paths of the mtca4u commands in-process, i.e. without process startup, dmap parsing and opening the
+ * device, which are done once before timing:
+ *  - read (readRegisterInternal() formatting, double and hex mode)
+ *  - read_seq (printSeqList() demux printing)
+ *  - write (writeRegister() value parsing)
+ *
+ * Usage: benchmarkMtca4u [iterations]
+ * Prints one CSV line per case: benchmark,size,iterations,seconds,calls_per_second
+ *
+ * The dummy devices DUMMY1 and DUMMY2 from dummies.dmap are used, so it has to run in the build directory.
+ */
+
+#include "Commands.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // Discards everything, so the formatting is timed but not the terminal output
+  class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override { return c; }
+  };
+
+  // Redirects std::cout into a NullBuffer for the lifetime of the object
+  class DiscardCout {
+   public:
+    DiscardCout() : _coutBuffer(std::cout.rdbuf(&_nullBuffer)) {}
+    ~DiscardCout() { std::cout.rdbuf(_coutBuffer); }
+
+    DiscardCout(const DiscardCout&) = delete;
+    DiscardCout& operator=(const DiscardCout&) = delete;
+
+   private:
+    NullBuffer _nullBuffer;
+    std::streambuf* _coutBuffer;
+  };
+
+  /********************************************************************************************************************/
+
+  void runCase(Session& session, const std::string& benchmark, size_t size, size_t iterations, const CmdFnc& command,
+      const std::vector<std::string>& args) {
+    std::vector<const char*> argv;
+    for(const auto& arg : args) {
+      argv.push_back(arg.c_str());
+    }
+
+    std::chrono::duration<double> seconds{};
+    {
+      DiscardCout discardCout;
+
+      // The first call opens the device and creates the accessors
+      command(session, argv.size(), argv.data());
+
+      auto start = std::chrono::steady_clock::now();
+      for(size_t i = 0; i < iterations; ++i) {
+        command(session, argv.size(), argv.data());
+      }
+      seconds = std::chrono::steady_clock::now() - start;
+    }
+
+    std::printf("%s,%zu,%zu,%.6f,%.3f\n", benchmark.c_str(), size, iterations, seconds.count(),
+        seconds.count() > 0 ? static_cast<double>(iterations) / seconds.count() : 0.);
+  }
+
+  /********************************************************************************************************************/
+
+  // space separated list of the values 1 to n for the write command
+  std::string valueList(size_t n) {
+    std::string list = "1";
+    for(size_t i = 2; i <= n; ++i) {
+      list += ' ';
+      list += std::to_string(i);
+    }
+    return list;
+  }
+
+} // namespace
+
+/**********************************************************************************************************************/
+
+int main(int argc, const char* argv[]) {
+  size_t iterations = (argc > 1) ? std::stoul(argv[1]) : 1000;
+
+  try {
+    Session session("dummies.dmap");
+
+    for(size_t size : {1, 64, 1024}) {
+      auto n = std::to_string(size);
+      runCase(session, "read_double", size, iterations, readRegister, {"DUMMY2", "ADC", "AREA_DMAABLE", "0", n});
+      runCase(session, "read_hex", size, iterations, readRegister, {"DUMMY2", "ADC", "AREA_DMAABLE", "0", n, "hex"});
+      runCase(session, "write", size, iterations, writeRegister, {"DUMMY2", "ADC", "AREA_DMAABLE", valueList(size)});
+    }
+
+    // the multiplexed region has 4 elements per sequence
+    for(size_t size : {1, 2, 4}) {
+      runCase(session, "read_seq", size, iterations, readMultiplexedData,
+          {"DUMMY1", "", "DMA", "", "0", std::to_string(size)});
+    }
+  }
+  catch(std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CApiTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "DummyDeviceLock.h"
+#include "mtca4u_c.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// NOTE: The test runs in the build directory, which contains the dmap and map files.
+
+namespace {
+  using SessionPtr = std::unique_ptr<mtca4u_session, decltype(&mtca4u_session_destroy)>;
+
+  SessionPtr createSession() {
+    SessionPtr session(mtca4u_session_create("dummies.dmap"), &mtca4u_session_destroy);
+    BOOST_REQUIRE(session);
+    return session;
+  }
+} // namespace
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testWriteRead) {
+  DummyDeviceLock lock("mtcadummys0");
+  auto session = createSession();
+
+  size_t size = 0;
+  BOOST_CHECK_EQUAL(mtca4u_register_size(session.get(), "DUMMY1", "", "WORD_CLK_MUX", &size), 0);
+  BOOST_CHECK_EQUAL(size, 4);
+
+  std::vector<double> written{78, 28, 91, 1};
+  BOOST_CHECK_EQUAL(mtca4u_write(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 0, written.data(), written.size()), 0);
+
+  std::vector<double> readBack(4);
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 0, readBack.data(), readBack.size()), 0);
+  BOOST_CHECK(readBack == written);
+
+  std::vector<int32_t> raw(2);
+  BOOST_CHECK_EQUAL(mtca4u_read_raw(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 2, raw.data(), raw.size()), 0);
+  BOOST_CHECK((raw == std::vector<int32_t>{91, 1}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadSequences) {
+  DummyDeviceLock lock("mtcadummys0");
+  auto session = createSession();
+
+  double one = 1;
+  BOOST_REQUIRE_EQUAL(mtca4u_write(session.get(), "DUMMY1", "", "WORD_ADC_ENA", 0, &one, 1), 0);
+
+  size_t numSequences = 0;
+  size_t numElementsPerSequence = 0;
+  BOOST_CHECK_EQUAL(
+      mtca4u_sequence_info(session.get(), "DUMMY1", "", "DMA", &numSequences, &numElementsPerSequence), 0);
+  BOOST_CHECK_EQUAL(numSequences, 5);
+  BOOST_CHECK_EQUAL(numElementsPerSequence, 4);
+
+  // values[i * 2 + j] is element 1 + i of sequence sequenceList[j], which is (5 * (1 + i) + sequenceList[j])^2
+  std::vector<unsigned int> sequenceList{4, 0};
+  std::vector<double> values(2 * 3);
+  BOOST_CHECK_EQUAL(mtca4u_read_sequences(session.get(), "DUMMY1", "", "DMA", sequenceList.data(), sequenceList.size(),
+                        1, values.data(), 3),
+      0);
+  BOOST_CHECK((values == std::vector<double>{81, 25, 196, 100, 361, 225}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testErrorReporting) {
+  DummyDeviceLock lock("mtcadummys0");
+  auto session = createSession();
+
+  BOOST_CHECK_EQUAL(std::string(mtca4u_last_error(session.get())), "");
+
+  double value = 0;
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", "NOT_EXISTING", 0, &value, 1), -1);
+  BOOST_CHECK_NE(std::string(mtca4u_last_error(session.get())), "");
+
+  // the error is cleared by the next successful call
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 0, &value, 1), 0);
+  BOOST_CHECK_EQUAL(std::string(mtca4u_last_error(session.get())), "");
+
+  // too many elements
+  std::vector<double> values(5);
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 0, values.data(), values.size()), -1);
+  BOOST_CHECK_NE(std::string(mtca4u_last_error(session.get())), "");
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSessionReset) {
+  DummyDeviceLock lock("mtcadummys0");
+  auto session = createSession();
+
+  double value = 17;
+  BOOST_CHECK_EQUAL(mtca4u_write(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 2, &value, 1), 0);
+
+  // the session is usable after the reset and opens the device again
+  BOOST_CHECK_EQUAL(mtca4u_session_reset(session.get()), 0);
+  value = 0;
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 2, &value, 1), 0);
+  BOOST_CHECK_EQUAL(value, 17);
+
+  BOOST_CHECK_EQUAL(mtca4u_session_reset(nullptr), -1);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testInvalidArguments) {
+  auto session = createSession();
+  double value = 0;
+
+  // NULL session
+  BOOST_CHECK_EQUAL(mtca4u_read(nullptr, "DUMMY1", "", "WORD_CLK_MUX", 0, &value, 1), -1);
+  BOOST_REQUIRE(mtca4u_last_error(nullptr) != nullptr);
+  BOOST_CHECK_NE(std::string(mtca4u_last_error(nullptr)), "");
+
+  // NULL strings and buffers
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), nullptr, "", "WORD_CLK_MUX", 0, &value, 1), -1);
+  BOOST_CHECK_NE(std::string(mtca4u_last_error(session.get())).find("device"), std::string::npos);
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", nullptr, "WORD_CLK_MUX", 0, &value, 1), -1);
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", nullptr, 0, &value, 1), -1);
+  BOOST_CHECK_EQUAL(mtca4u_read(session.get(), "DUMMY1", "", "WORD_CLK_MUX", 0, nullptr, 1), -1);
+  BOOST_CHECK_EQUAL(mtca4u_register_size(session.get(), "DUMMY1", "", "WORD_CLK_MUX", nullptr), -1);
+
+  // numSequences * numElements overflows
+  std::vector<unsigned int> sequenceList{0, 1};
+  BOOST_CHECK_EQUAL(mtca4u_read_sequences(session.get(), "DUMMY1", "", "DMA", sequenceList.data(), sequenceList.size(),
+                        0, &value, std::numeric_limits<size_t>::max() / 2 + 1),
+      -1);
+  BOOST_CHECK_NE(std::string(mtca4u_last_error(session.get())), "");
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testCatalogue) {
+  auto session = createSession();
+
+  size_t requiredSize = 0;
+  BOOST_REQUIRE_EQUAL(mtca4u_device_list(session.get(), nullptr, 0, &requiredSize), 0);
+  std::vector<char> buffer(requiredSize);
+  BOOST_REQUIRE_EQUAL(mtca4u_device_list(session.get(), buffer.data(), buffer.size(), &requiredSize), 0);
+  BOOST_CHECK_EQUAL(std::string(buffer.data()).substr(0, std::string(buffer.data()).find('\n')),
+      "DUMMY1\t(pci:mtcadummys0?map=mtcadummy_withoutModules.map)\t");
+
+  // buffer too small
+  BOOST_CHECK_EQUAL(mtca4u_device_list(session.get(), buffer.data(), 10, &requiredSize), -1);
+  BOOST_CHECK_EQUAL(requiredSize, buffer.size());
+
+  DummyDeviceLock lock("mtcadummys1");
+
+  mtca4u_register_entry info;
+  BOOST_REQUIRE_EQUAL(mtca4u_register_info(session.get(), "DUMMY2", "BOARD", "WORD_USER", &info), 0);
+  BOOST_CHECK_EQUAL(info.nElements, 1);
+  BOOST_CHECK(info.isNumericAddressed);
+  BOOST_CHECK(info.isSigned);
+  BOOST_CHECK_EQUAL(info.width, 12);
+  BOOST_CHECK_EQUAL(info.nFractionalBits, 3);
+
+  BOOST_REQUIRE_EQUAL(mtca4u_register_list(session.get(), "DUMMY2", nullptr, 0, &requiredSize), 0);
+  buffer.resize(requiredSize);
+  BOOST_REQUIRE_EQUAL(mtca4u_register_list(session.get(), "DUMMY2", buffer.data(), buffer.size(), &requiredSize), 0);
+  BOOST_CHECK_NE(std::string(buffer.data()).find("/ADC/AREA_DMAABLE\n"), std::string::npos);
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE SessionTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "DummyDeviceLock.h"
+#include "Session.h"
+
+#include <algorithm>
+#include <vector>
+
+using ChimeraTK::command_line_tools::Session;
+
+// NOTE: The test runs in the build directory, which contains the dmap and map files.
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testWriteReadRoundTrip) {
+  DummyDeviceLock lock("mtcadummys0");
+  Session session("dummies.dmap");
+
+  std::vector<double> written{78, 28, 91, 1};
+  session.write("DUMMY1", "WORD_CLK_MUX", written);
+  auto* device = &session.getDevice("DUMMY1");
+
+  std::vector<double> readBack(4);
+  session.read("DUMMY1", "WORD_CLK_MUX", readBack);
+  BOOST_CHECK(readBack == written);
+
+  // A second transfer with the same session works on the already opened device
+  written = {14, 12, 11, 144};
+  session.write("DUMMY1", "WORD_CLK_MUX", written);
+  session.read("DUMMY1", "WORD_CLK_MUX", readBack);
+  BOOST_CHECK(readBack == written);
+  BOOST_CHECK_EQUAL(&session.getDevice("DUMMY1"), device);
+
+  // Partial access with offset
+  std::vector<double> part{5, 6};
+  session.write("DUMMY1", "WORD_CLK_MUX", part, 1);
+  session.read("DUMMY1", "WORD_CLK_MUX", readBack);
+  BOOST_CHECK((readBack == std::vector<double>{14, 5, 6, 144}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testClear) {
+  DummyDeviceLock lock("mtcadummys0");
+  Session session("dummies.dmap");
+
+  std::vector<double> written{3, 1, 4, 1};
+  session.write("DUMMY1", "WORD_CLK_MUX", written);
+
+  // The device is opened again on the next access
+  session.clear();
+  std::vector<double> readBack(4);
+  session.read("DUMMY1", "WORD_CLK_MUX", readBack);
+  BOOST_CHECK(readBack == written);
+  BOOST_CHECK(session.getDevice("DUMMY1").isOpened());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testManyAccessors) {
+  DummyDeviceLock lock("mtcadummys0");
+  Session session("dummies.dmap");
+
+  // Fill the DMA region with the parabolic test pattern, element i is i^2
+  std::vector<double> value{1};
+  session.write("DUMMY1", "WORD_ADC_ENA", value);
+
+  // More different ranges than accessors are cached. Dropping the cache must not affect the results.
+  for(size_t i = 0; i < 2 * Session::maxCachedAccessors + 1; ++i) {
+    session.read("DUMMY1", "AREA_DMAABLE", value, i);
+    BOOST_CHECK_EQUAL(value[0], static_cast<double>(i * i));
+    BOOST_CHECK_EQUAL(session.getNumberOfElements("DUMMY1", "AREA_DMAABLE", 0, i), 1024 - i);
+    BOOST_CHECK_EQUAL(session.getNumberOfElements<int32_t>("DUMMY1", "AREA_DMAABLE", 0, i), 1024 - i);
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadRaw) {
+  DummyDeviceLock lock("mtcadummys0");
+  Session session("dummies.dmap");
+
+  // WORD_USER is a signed 12 bit fixed point register with 3 fractional bits
+  std::vector<double> value{1.5};
+  session.write("DUMMY1", "WORD_USER", value);
+
+  std::vector<int32_t> raw(1);
+  session.readRaw("DUMMY1", "WORD_USER", raw);
+  BOOST_CHECK_EQUAL(raw[0], 12);
+
+  session.read("DUMMY1", "WORD_USER", value);
+  BOOST_CHECK_CLOSE(value[0], 1.5, 1e-9);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testNumberOfElements) {
+  DummyDeviceLock lock("mtcadummys0");
+  Session session("dummies.dmap");
+
+  // numElements == 0 means the rest of the register, starting at the offset
+  BOOST_CHECK_EQUAL(session.getNumberOfElements("DUMMY1", "WORD_CLK_MUX"), 4);
+  BOOST_CHECK_EQUAL(session.getNumberOfElements("DUMMY1", "WORD_CLK_MUX", 0, 1), 3);
+  BOOST_CHECK_EQUAL(session.getNumberOfElements("DUMMY1", "WORD_CLK_MUX", 2, 1), 2);
+  BOOST_CHECK_EQUAL(session.getNumberOfElements<int32_t>("DUMMY1", "WORD_CLK_MUX"), 4);
+  BOOST_CHECK_EQUAL(session.getNumberOfElements<int32_t>("DUMMY1", "WORD_CLK_MUX", 0, 3), 1);
+
+  BOOST_CHECK_THROW(session.getNumberOfElements("DUMMY1", "WORD_CLK_MUX", 5), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(session.getNumberOfElements("DUMMY1", "WORD_CLK_MUX", 4, 1), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(session.getNumberOfElements<int32_t>("DUMMY1", "WORD_CLK_MUX", 5), ChimeraTK::logic_error);
+
+  BOOST_CHECK_EQUAL(session.getRegisterSize("DUMMY1", "WORD_CLK_MUX"), 4);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadSequences) {
+  DummyDeviceLock lock("mtcadummys0");
+  Session session("dummies.dmap");
+
+  // Fill the DMA region with the parabolic test pattern. Element i of sequence j then is (5 * i + j)^2.
+  std::vector<double> one{1};
+  session.write("DUMMY1", "WORD_ADC_ENA", one);
+
+  auto info = session.getSequenceInfo("DUMMY1", "DMA");
+  BOOST_CHECK_EQUAL(info.nSequences, 5);
+  BOOST_CHECK_EQUAL(info.nElementsPerSequence, 4);
+
+  // all sequences: values[i * 5 + j] is element i of sequence j
+  std::vector<unsigned int> all{0, 1, 2, 3, 4};
+  std::vector<double> values(5 * 4);
+  session.readSequences("DUMMY1", "DMA", all, values);
+  for(size_t i = 0; i < 4; ++i) {
+    for(size_t j = 0; j < 5; ++j) {
+      auto expected = static_cast<double>(5 * i + j);
+      BOOST_CHECK_EQUAL(values[i * 5 + j], expected * expected);
+    }
+  }
+
+  // selected sequences in the given order, with offset
+  std::vector<unsigned int> selected{3, 1};
+  values.resize(2 * 2);
+  session.readSequences("DUMMY1", "DMA", selected, values, 1);
+  for(size_t i = 0; i < 2; ++i) {
+    for(size_t j = 0; j < 2; ++j) {
+      auto expected = static_cast<double>(5 * (1 + i) + selected[j]);
+      BOOST_CHECK_EQUAL(values[i * 2 + j], expected * expected);
+    }
+  }
+
+  values.resize(3);
+  BOOST_CHECK_THROW(session.readSequences("DUMMY1", "DMA", selected, values), ChimeraTK::logic_error);
+
+  values.resize(2);
+  std::vector<unsigned int> invalid{5};
+  BOOST_CHECK_THROW(session.readSequences("DUMMY1", "DMA", invalid, values), ChimeraTK::logic_error);
+
+  values.resize(2 * 2);
+  BOOST_CHECK_THROW(session.readSequences("DUMMY1", "DMA", selected, values, 3), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testCatalogue) {
+  Session session("dummies.dmap");
+
+  auto devices = session.getDeviceList();
+  BOOST_REQUIRE_EQUAL(devices.size(), 5);
+  BOOST_CHECK_EQUAL(devices[0].alias, "DUMMY1");
+  BOOST_CHECK_EQUAL(devices[0].cdd, "(pci:mtcadummys0?map=mtcadummy_withoutModules.map)");
+
+  DummyDeviceLock lock("mtcadummys1");
+
+  auto registers = session.getRegisterList("DUMMY2");
+  BOOST_CHECK(std::ranges::any_of(
+      registers, [](auto& r) { return r.name == ChimeraTK::RegisterPath("ADC/AREA_DMAABLE") && r.nElements == 1024; }));
+
+  auto reg = session.getRegisterInfo("DUMMY2", "BOARD/WORD_USER");
+  BOOST_CHECK_EQUAL(reg.nDimensions, 1);
+  BOOST_CHECK_EQUAL(reg.nElements, 1);
+  BOOST_CHECK(reg.isNumericAddressed);
+  BOOST_CHECK(reg.signedFlag);
+  BOOST_CHECK_EQUAL(reg.width, 12);
+  BOOST_CHECK_EQUAL(reg.nFractionalBits, 3);
+
+  BOOST_CHECK_THROW(session.getRegisterInfo("DUMMY2", "ADC/NOT_EXISTING"), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
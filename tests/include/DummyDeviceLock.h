@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <sys/file.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/**
+ * Holds the lock of a mtcadummy device for the lifetime of the object. It is the same lock the test scripts take with
+ * flock, so tests using the same dummy device do not run concurrently.
+ */
+class DummyDeviceLock {
+ public:
+  explicit DummyDeviceLock(const std::string& deviceNode) {
+    boost::filesystem::create_directories("/var/run/lock/mtcadummy");
+    _fd = open(("/var/run/lock/mtcadummy/" + deviceNode).c_str(), O_RDWR | O_CREAT, 0666);
+    if(_fd < 0) {
+      throw std::runtime_error("Cannot open the lock file of dummy device " + deviceNode);
+    }
+    if(flock(_fd, LOCK_EX) != 0) {
+      close(_fd);
+      throw std::runtime_error("Cannot lock dummy device " + deviceNode);
+    }
+  }
+
+  ~DummyDeviceLock() { close(_fd); }
+
+  DummyDeviceLock(const DummyDeviceLock&) = delete;
+  DummyDeviceLock& operator=(const DummyDeviceLock&) = delete;
+
+ private:
+  int _fd;
+};
@@ -0,0 +1,102 @@
+#!/bin/bash -e
+
+
+# Benchmark of the mtca4u commands, run by 'make mtca4u_benchmarks' or 'ctest -L benchmark':
+#  - startup: complete mtca4u calls (process start, alias lookup, device open, catalogue lookup), timed here
+#  - cold_read: complete 'mtca4u read' calls with an existing alias index, timed here. The average time of a call must
+#    not exceed MTCA4U_BENCHMARK_COLD_READ_LIMIT_MS (default 10), independent of the baseline.
+#  - read, read_seq, write: the command implementations in-process, timed by the benchmarkMtca4u executable
+#
+# Results are written as CSV to ${results_file}:
+#   benchmark,size,iterations,seconds,calls_per_second
+#
+# The results are compared against the baseline file given in MTCA4U_BENCHMARK_BASELINE. The script fails if the
+# throughput of any case is more than MTCA4U_BENCHMARK_MARGIN percent (default 20) below the baseline, or if no
+# baseline is given. Set MTCA4U_BENCHMARK_UPDATE_BASELINE=1 to store the results as baseline instead.
+
+# NOTE: Paths specified below, assume the working directory is the build
+# directory
+mtca4u_executable=./mtca4u
+benchmark_executable=./benchmarkMtca4u
+results_file="${PWD}/benchmarkResults.csv"
+baseline_file="${MTCA4U_BENCHMARK_BASELINE}"
+regression_margin="${MTCA4U_BENCHMARK_MARGIN:-20}"
+iterations="${MTCA4U_BENCHMARK_ITERATIONS:-1000}"
+startup_iterations="${MTCA4U_BENCHMARK_STARTUP_ITERATIONS:-100}"
+cold_read_limit_ms="${MTCA4U_BENCHMARK_COLD_READ_LIMIT_MS:-10}"
+update_baseline="${MTCA4U_BENCHMARK_UPDATE_BASELINE:-0}"
+
+if [ -z "$baseline_file" ]; then
+  echo "No benchmark baseline given. Set MTCA4U_BENCHMARK_BASELINE to the baseline file when running cmake." \
+       "To create it, also set MTCA4U_BENCHMARK_UPDATE_BASELINE=1 in the environment." >&2
+  exit 1
+fi
+if [ ! -f "$baseline_file" ] && [ "$update_baseline" != "1" ]; then
+  echo "Benchmark baseline ${baseline_file} does not exist. Set MTCA4U_BENCHMARK_UPDATE_BASELINE=1 to create it." >&2
+  exit 1
+fi
+
+echo "benchmark,size,iterations,seconds,calls_per_second" > "$results_file"
+
+mkdir -p /var/run/lock/mtcadummy
+( flock 9 # lock for mtcadummys0
+  ( flock 8 # lock for mtcadummys1
+
+    # Make sure the DMA regions contain the parabolic values
+    $mtca4u_executable write DUMMY1 "" WORD_ADC_ENA 1
+    $mtca4u_executable write DUMMY2 ADC WORD_ADC_ENA 1
+
+    # startup: no data transfer, so this is the time for a complete mtca4u call
+    start=$(date +%s%N)
+    for ((i = 0; i < startup_iterations; i++)); do
+      $mtca4u_executable register_size DUMMY2 ADC WORD_CLK_MUX > /dev/null
+    done
+    stop=$(date +%s%N)
+    awk -v n="$startup_iterations" -v t="$((stop - start))" \
+      'BEGIN { sec = t / 1e9; printf "startup,1,%d,%.6f,%.3f\n", n, sec, (sec > 0 ? n / sec : 0) }' >> "$results_file"
+
+    # cold_read: the first call creates the alias index, the timed calls use it
+    $mtca4u_executable read DUMMY2 ADC WORD_CLK_DUMMY > /dev/null
+    start=$(date +%s%N)
+    for ((i = 0; i < startup_iterations; i++)); do
+      $mtca4u_executable read DUMMY2 ADC WORD_CLK_DUMMY > /dev/null
+    done
+    stop=$(date +%s%N)
+    awk -v n="$startup_iterations" -v t="$((stop - start))" \
+      'BEGIN { sec = t / 1e9; printf "cold_read,1,%d,%.6f,%.3f\n", n, sec, (sec > 0 ? n / sec : 0) }' >> "$results_file"
+    cold_read_us=$(( (stop - start) / startup_iterations / 1000 ))
+
+    $benchmark_executable "$iterations" >> "$results_file"
+
+    # restore the parabolic values overwritten by the write benchmark
+    $mtca4u_executable write DUMMY2 ADC WORD_ADC_ENA 1
+
+  ) 8>/var/run/lock/mtcadummy/mtcadummys1
+) 9>/var/run/lock/mtcadummy/mtcadummys0
+
+cat "$results_file"
+
+if [ "$cold_read_us" -gt "$((cold_read_limit_ms * 1000))" ]; then
+  echo "REGRESSION: cold_read takes ${cold_read_us} us per call, limit ${cold_read_limit_ms} ms" >&2
+  exit 1
+fi
+
+if [ "$update_baseline" = "1" ]; then
+  cp "$results_file" "$baseline_file"
+  echo "Stored benchmark baseline in ${baseline_file}"
+  exit 0
+fi
+
+# compare against the baseline. Cases missing in the baseline are ignored.
+awk -F, -v margin="$regression_margin" '
+  FNR == 1 { next }
+  NR == FNR { baseline[$1 "," $2] = $5; next }
+  ($1 "," $2) in baseline {
+    limit = baseline[$1 "," $2] * (1 - margin / 100)
+    if ($5 < limit) {
+      printf "REGRESSION: %s size %s: %.3f calls/s, baseline %.3f calls/s (margin %s%%)\n", $1, $2, $5, baseline[$1 "," $2], margin
+      failed = 1
+    }
+  }
+  END { exit failed }
+' "$baseline_file" "$results_file"
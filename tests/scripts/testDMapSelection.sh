@@ -0,0 +1,61 @@
+#!/bin/bash -e
+
+
+mtca4u_executable="${PWD}/mtca4u"
+actual_console_output="${PWD}/output_testDMapSelection.txt"
+expected_console_output="${PWD}/referenceTexts/referenceDMapSelection.txt"
+TEST_BASE_DIR="${PWD}"
+# keep the alias index files in the build directory also when not started by ctest
+export XDG_CACHE_HOME="${XDG_CACHE_HOME:-${TEST_BASE_DIR}/aliasIndexCache}"
+
+mkdir -p /var/run/lock/mtcadummy
+( flock 9 # lock for mtcadummys0
+
+  {
+    for TESTDIR in testNoDmapFile testTwoDmapFilesBroken; do
+        cd "${TEST_BASE_DIR}/${TESTDIR}"
+        echo "*** Tests in ${TESTDIR} ***"
+
+        echo Testing --dmap
+        "${mtca4u_executable}" --dmap ../dummies.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing MTCA4U_DMAP_FILE
+        MTCA4U_DMAP_FILE=../dummies.dmap "${mtca4u_executable}" read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing --dmap with unknown alias
+        ! "${mtca4u_executable}" --dmap ../dummies.dmap read NON_EXISTENT_DEVICE "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing --dmap with missing file
+        ! "${mtca4u_executable}" --dmap ../missing.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing --dmap takes precedence over MTCA4U_DMAP_FILE
+        MTCA4U_DMAP_FILE=../missing.dmap "${mtca4u_executable}" --dmap ../dummies.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing --dmap with existing alias index
+        ls "${XDG_CACHE_HOME}"/mtca4u/*.idx > /dev/null
+        "${mtca4u_executable}" --dmap ../dummies.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing --dmap with unwritable cache directory
+        XDG_CACHE_HOME=/dev/null "${mtca4u_executable}" --dmap ../dummies.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+        echo Testing --dmap without alias index
+        MTCA4U_NO_ALIAS_INDEX=1 "${mtca4u_executable}" --dmap ../dummies.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+
+        echo .
+    done
+
+    # The alias index is rebuilt when the dmap file changes
+    mkdir -p "${TEST_BASE_DIR}/testAliasIndex"
+    cd "${TEST_BASE_DIR}/testAliasIndex"
+    echo "*** Tests in testAliasIndex ***"
+    echo "DUMMY1 (pci:mtcadummys0?map=../mtcadummy_withoutModules.map)" > aliasIndex.dmap
+    echo Testing alias index of original dmap file
+    "${mtca4u_executable}" --dmap aliasIndex.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+    echo "RENAMED_DUMMY1 (pci:mtcadummys0?map=../mtcadummy_withoutModules.map)" > aliasIndex.dmap
+    echo Testing alias index of changed dmap file
+    ! "${mtca4u_executable}" --dmap aliasIndex.dmap read DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+    "${mtca4u_executable}" --dmap aliasIndex.dmap read RENAMED_DUMMY1 "" WORD_CLK_DUMMY 0 0 hex
+    echo .
+  } &> "${actual_console_output}"
+
+) 9>/var/run/lock/mtcadummy/mtcadummys0
+
+# remove the build directory from the dmap file path in the error messages
+sed "{s|${TEST_BASE_DIR}|BUILD_DIR|g}" -i "${actual_console_output}"
+
+cd "${TEST_BASE_DIR}"
+scripts/filterOutput.sh $actual_console_output > ${actual_console_output}-filtered
+diff "${actual_console_output}-filtered" "$expected_console_output"